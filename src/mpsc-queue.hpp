@@ -0,0 +1,113 @@
+// mpsc-queue.hpp
+// A bounded, lock-free queue with many producers and a single consumer.
+// Based on Dmitry Vyukov's bounded MPMC queue: every cell carries a sequence
+// number that tells producers and the consumer whose turn it is to use it.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+template <class T>
+class MpscQueue {
+ public:
+  // The capacity must be a power of two.
+  explicit MpscQueue(size_t capacity)
+      : mask(capacity - 1), cells(new Cell[capacity]) {
+    if (capacity < 2 || (capacity & mask) != 0) {
+      throw std::invalid_argument("MpscQueue capacity must be a power of two");
+    }
+    for (size_t i = 0; i < capacity; ++i) {
+      cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  // Safe to call from any thread. Returns false if the queue is full.
+  bool TryPush(const T& value) {
+    Cell* cell;
+    size_t pos = tail.load(std::memory_order_relaxed);
+    while (true) {
+      cell = &cells[pos & mask];
+      const size_t sequence = cell->sequence.load(std::memory_order_acquire);
+      const intptr_t diff =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        // The cell is free, so try to claim it.
+        if (tail.compare_exchange_weak(pos, pos + 1,
+                                       std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        // The consumer has not emptied this cell yet.
+        return false;
+      } else {
+        // Another producer claimed this cell first.
+        pos = tail.load(std::memory_order_relaxed);
+      }
+    }
+    cell->value = value;
+    // Hand the cell over to the consumer.
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Must only be called from the consumer thread. Returns false if the queue
+  // is empty.
+  bool TryPop(T& value) {
+    Cell& cell = cells[head & mask];
+    if (cell.sequence.load(std::memory_order_acquire) != head + 1) {
+      return false;
+    }
+    value = cell.value;
+    // Hand the cell back to the producers for their next lap.
+    cell.sequence.store(head + mask + 1, std::memory_order_release);
+    ++head;
+    return true;
+  }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  const size_t mask;
+  const std::unique_ptr<Cell[]> cells;
+  // Keep the producer and consumer positions on separate cache lines.
+  alignas(64) std::atomic<size_t> tail{0};
+  alignas(64) size_t head = 0;
+};
+
+// For a consumer waiting on an empty MpscQueue. Yields for a while in case the
+// wait is short, then sleeps for longer and longer so that an idle thread does
+// not take a core away from the threads doing the work.
+class Backoff {
+ public:
+  void Wait() {
+    if (spins < kSpins) {
+      ++spins;
+      std::this_thread::yield();
+      return;
+    }
+    std::this_thread::sleep_for(sleep);
+    sleep = std::min(sleep * 2, kMaxSleep);
+  }
+
+  // Call after making progress, so that the next wait starts out short.
+  void Reset() {
+    spins = 0;
+    sleep = kMinSleep;
+  }
+
+ private:
+  static constexpr size_t kSpins = 64;
+  static constexpr std::chrono::microseconds kMinSleep{10};
+  static constexpr std::chrono::microseconds kMaxSleep{1000};
+
+  size_t spins = 0;
+  std::chrono::microseconds sleep = kMinSleep;
+};
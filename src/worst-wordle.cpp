@@ -2,6 +2,8 @@
 
 #include "worst-wordle.hpp"
 
+#include <algorithm>
+#include <cctype>
 #include <iostream>
 #include <string>
 
@@ -9,30 +11,102 @@ void print_usage(const std::string& program_name) {
   std::cout << "Usage: " << program_name << " [options]\n\n"
             << "Options:\n"
             << "  -h, --help      Display this help message\n"
+            << "  -d, --database <file>\n"
+            << "                  Optional: Reuse the results stored in this\n"
+            << "                  file and only search what changed in the\n"
+            << "                  wordlists, then store the new results\n"
+            << "  -e, --expand-threads <n>\n"
+            << "                  Optional: Number of threads that turn the\n"
+            << "                  letter sets found by the search into words\n"
+            << "                  (1 to 256, ignored when parallelism is\n"
+            << "                  disabled). The search gets the other cores\n"
             << "  <guess_list>    Optional: Path to the guess wordlist file\n"
             << "  <ans_list>      Optional: Path to the answer wordlist file\n"
             << std::endl;
 }
 
 int main(int argc, char* argv[]) {
-  if (argc > 1 &&
-      (std::string(argv[1]) == "-h" || std::string(argv[1]) == "--help")) {
-    print_usage(argv[0]);
-    return 0;
+  std::vector<std::string> positional;
+  std::filesystem::path databasePath;
+  size_t expandThreads = WorstWordle::DefaultExpandThreads();
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg(argv[i]);
+    if (arg == "-h" || arg == "--help") {
+      print_usage(argv[0]);
+      return 0;
+    } else if (arg == "-d" || arg == "--database") {
+      if (i + 1 >= argc) {
+        print_usage(argv[0]);
+        return 1;
+      }
+      databasePath = argv[++i];
+    } else if (arg == "-e" || arg == "--expand-threads") {
+      if (i + 1 >= argc) {
+        print_usage(argv[0]);
+        return 1;
+      }
+      const std::string value(argv[++i]);
+      // std::stoul would accept a sign or trailing characters.
+      const bool isNumber =
+          !value.empty() &&
+          std::all_of(value.begin(), value.end(),
+                      [](unsigned char c) { return std::isdigit(c); });
+      unsigned long threads = 0;
+      try {
+        threads = isNumber ? std::stoul(value) : 0;
+      } catch (const std::out_of_range&) {
+        threads = 0;
+      }
+      if (threads == 0 || threads > WorstWordle::kMaxExpandThreads) {
+        std::cout << "Invalid number of expansion threads: " << value
+                  << std::endl;
+        print_usage(argv[0]);
+        return 1;
+      }
+      expandThreads = threads;
+#ifdef DISABLE_MULTITHREAD_OPTIMIZATION
+      std::cout << "WARNING: Parallelism is disabled, so " << arg
+                << " is ignored." << std::endl;
+#endif
+    } else {
+      positional.push_back(arg);
+    }
   }
   std::filesystem::path guessListPath =
-      (argc > 1) ? std::filesystem::path(argv[1])
-                 : std::filesystem::path("wordlists/nyt/guess.txt");
+      (positional.size() > 0)
+          ? std::filesystem::path(positional[0])
+          : std::filesystem::path("wordlists/nyt/guess.txt");
   std::filesystem::path ansListPath =
-      (argc > 2) ? std::filesystem::path(argv[2])
-                 : std::filesystem::path("wordlists/nyt/answer.txt");
-  WorstWordle worstWordle(guessListPath, ansListPath);
+      (positional.size() > 1)
+          ? std::filesystem::path(positional[1])
+          : std::filesystem::path("wordlists/nyt/answer.txt");
+  WorstWordle worstWordle(guessListPath, ansListPath, expandThreads);
 #ifndef DISABLE_MULTITHREAD_OPTIMIZATION
   const bool useFutures = true;
 #else
   const bool useFutures = false;
 #endif
-  worstWordle.FindWorstWordle(useFutures);
+  if (databasePath.empty()) {
+    worstWordle.FindWorstWordle(useFutures);
+    return 0;
+  }
+  ResultDatabase previous;
+  bool loaded = false;
+  if (std::filesystem::exists(databasePath)) {
+    try {
+      previous = ResultDatabase::Load(databasePath);
+      loaded = true;
+    } catch (const std::runtime_error& e) {
+      std::cout << "WARNING: " << e.what() << ". Running a full search instead."
+                << std::endl;
+    }
+  }
+  if (loaded) {
+    worstWordle.FindWorstWordleIncremental(previous, useFutures);
+  } else {
+    worstWordle.FindWorstWordle(useFutures, true);
+  }
+  worstWordle.SaveDatabase(databasePath);
 
   return 0;
-}
\ No newline at end of file
+}
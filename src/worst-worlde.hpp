@@ -5,6 +5,7 @@
 #include <atomic>
 #include <bitset>
 #include <chrono>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <future>
@@ -16,13 +17,21 @@
 #include <unordered_set>
 #include <vector>
 
+#include "mpsc-queue.hpp"
 #include "thread-pool.hpp"
 
 // Forward-declared classes.
 class Word;
 class LetterSet;
+class ResultDatabase;
 class WorstWordle;
 
+// A letter set packed into an integer. Unlike an index into a wordlist, this
+// stays stable when words are added to or removed from the wordlists.
+using SetId = uint32_t;
+// The IDs of the 6 guess sets that make up one DFS leaf, in ascending order.
+using Leaf = std::array<SetId, 6>;
+
 class Word {
  public:
   Word(std::string str) {
@@ -54,6 +63,7 @@ class LetterSet {
     }
   }
   const std::bitset<26> GetSet() const { return set; }
+  SetId GetId() const { return static_cast<SetId>(set.to_ulong()); }
   // Should be run before sorting a LetterSet.
   static void SetLetterFrequency(const std::vector<LetterSet>& setList,
                                  const bool& report = false) {
@@ -191,16 +201,139 @@ class LetterSet {
   static std::unordered_map<char, double> letterFrequency;
 };
 
+// The results of a previous run, saved so that a later run against edited
+// wordlists only has to search the parts of the tree that changed.
+// Only leaves with at least one valid answer are kept. Words are not stored,
+// since they are recovered from the current wordlists when a leaf is expanded.
+class ResultDatabase {
+ public:
+  // Build flags that change which leaves are found. A database is only reused
+  // by a build with the same flags.
+  static uint32_t BuildFlags() {
+    uint32_t flags = 0;
+#ifdef DISABLE_VOWEL_OPTIMIZATION
+    flags |= 1 << 0;
+#endif
+#ifdef DISABLE_PERMUTATION_DEDUP
+    flags |= 1 << 1;
+#endif
+    return flags;
+  }
+
+  static ResultDatabase Load(const std::filesystem::path& file) {
+    std::ifstream in(file, std::ios::binary);
+    if (!in) {
+      throw std::runtime_error("Could not open file: " + file.string());
+    }
+    ResultDatabase db;
+    std::array<char, 4> magic;
+    uint32_t version = 0;
+    in.read(magic.data(), magic.size());
+    Read(in, version);
+    if (!in || magic != kMagic || version != kVersion) {
+      throw std::runtime_error("Not a result database: " + file.string());
+    }
+    Read(in, db.flags);
+    ReadVector(in, db.guessSetIds);
+    ReadVector(in, db.answerSetIds);
+    ReadVector(in, db.leaves);
+    if (!in) {
+      throw std::runtime_error("Truncated result database: " + file.string());
+    }
+    return db;
+  }
+
+  // Writes to a temporary file first, so that an interrupted save leaves the
+  // old database in place.
+  void Save(const std::filesystem::path& file) const {
+    std::filesystem::path tmpFile = file;
+    tmpFile += ".tmp";
+    std::ofstream out(tmpFile, std::ios::binary | std::ios::trunc);
+    if (!out) {
+      throw std::runtime_error("Could not open file: " + tmpFile.string());
+    }
+    out.write(kMagic.data(), kMagic.size());
+    Write(out, kVersion);
+    Write(out, flags);
+    WriteVector(out, guessSetIds);
+    WriteVector(out, answerSetIds);
+    WriteVector(out, leaves);
+    out.close();
+    if (!out) {
+      throw std::runtime_error("Could not write file: " + tmpFile.string());
+    }
+    std::filesystem::rename(tmpFile, file);
+  }
+
+  struct LeafHash {
+    size_t operator()(const Leaf& leaf) const {
+      size_t hash = 0;
+      for (const SetId id : leaf) {
+        hash = hash * 31 + std::hash<SetId>{}(id);
+      }
+      return hash;
+    }
+  };
+
+  uint32_t flags = BuildFlags();
+  // Sorted IDs of every set in the wordlists used to find the leaves.
+  std::vector<SetId> guessSetIds;
+  std::vector<SetId> answerSetIds;
+  std::vector<Leaf> leaves;
+
+ private:
+  static constexpr std::array<char, 4> kMagic = {'W', 'W', 'D', 'B'};
+  static constexpr uint32_t kVersion = 1;
+
+  template <class T>
+  static void Read(std::istream& in, T& value) {
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+  }
+  template <class T>
+  static void Write(std::ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+  template <class T>
+  static void ReadVector(std::istream& in, std::vector<T>& values) {
+    uint64_t size = 0;
+    Read(in, size);
+    if (!in) {
+      return;
+    }
+    // Check the size against what is left of the file before allocating, so
+    // that a corrupt size is reported as a truncated file.
+    const std::streampos pos = in.tellg();
+    in.seekg(0, std::ios::end);
+    const uint64_t remaining = static_cast<uint64_t>(in.tellg() - pos);
+    in.seekg(pos);
+    if (size > remaining / sizeof(T)) {
+      in.setstate(std::ios::failbit);
+      return;
+    }
+    values.resize(size);
+    in.read(reinterpret_cast<char*>(values.data()), size * sizeof(T));
+  }
+  template <class T>
+  static void WriteVector(std::ostream& out, const std::vector<T>& values) {
+    Write(out, static_cast<uint64_t>(values.size()));
+    out.write(reinterpret_cast<const char*>(values.data()),
+              values.size() * sizeof(T));
+  }
+};
+
 class WorstWordle {
  public:
   WorstWordle(const std::filesystem::path& guessList,
-              const std::filesystem::path& answerList)
-      : guessWords(GetWordlist(guessList)),
+              const std::filesystem::path& answerList,
+              const size_t expandThreads = DefaultExpandThreads())
+      : expandThreads(expandThreads),
+        guessWords(GetWordlist(guessList)),
         ansWords(GetWordlist(answerList)),
         guessSets(ToSetList(guessWords)),
         answerSets(ToSetList(ansWords)),
         setToWordsGuess(PopulateMultimap(guessWords)),
-        setToWordsAns(PopulateMultimap(ansWords)) {
+        setToWordsAns(PopulateMultimap(ansWords)),
+        pool(SearchThreads(expandThreads)) {
     startTime = std::chrono::steady_clock::now();
     LetterSet::SetLetterFrequency(guessSets);
     std::sort(guessSets.begin(), guessSets.end(), LetterSet::Compare());
@@ -211,60 +344,178 @@ class WorstWordle {
   // different than another solution.
   // A solution is only considered correct if no letters are reused across
   // words.
-  void FindWorstWordle(const bool useFutures = true) {
+  void FindWorstWordle(const bool useFutures = true,
+                       const bool recordLeaves = false) {
+    this->recordLeaves = recordLeaves;
     std::vector<LetterSet> chosenSets;
     // We will always have exactly 6 sets per guess.
     chosenSets.reserve(6);
-#ifdef DISABLE_VOWEL_OPTIMIZATION
-    FindWorstWordleRecursive(chosenSets, LetterSet(), guessSets, useFutures);
+    StartExpansion(useFutures);
+    FindWorstWordleStart(chosenSets, LetterSet(), guessSets, useFutures);
+
+    // Wait for all parallel tasks to complete.
+    WaitForFutures();
+    FinishExpansion();
+  }
+
+  // Split the cores by how much of the work each stage does. With one thread,
+  // NO_PRINT and the nyt wordlists, the search alone takes 73s of a 623s run,
+  // so the expansion stage gets about 7/8 of the cores and the search gets the
+  // rest. Search threads also expand leaves themselves whenever the queues are
+  // full, so a bad split costs less than it otherwise would.
+  static size_t DefaultExpandThreads() {
+    const size_t cores =
+        std::max<size_t>(1, std::thread::hardware_concurrency());
+    return std::max<size_t>(1, cores * 7 / 8);
+  }
+  static size_t SearchThreads(const size_t expandThreads) {
+    const size_t cores = std::thread::hardware_concurrency();
+    return cores > expandThreads ? cores - expandThreads : 1;
+  }
+  static constexpr size_t kMaxExpandThreads = 256;
+
+  // Find the same solutions as FindWorstWordle, but reuse the leaves found by
+  // a previous run and only search the parts of the tree that the wordlist
+  // changes affect:
+  // - Leaves that use a removed guess set are dropped.
+  // - Leaves that use an added guess set are searched for.
+  // - Leaves of unchanged guess sets are searched for only if they are valid
+  // for an added answer set.
+  // Every leaf is checked against the current answers when it is expanded, so
+  // removed answers drop out on their own.
+  void FindWorstWordleIncremental(const ResultDatabase& previous,
+                                  const bool useFutures = true) {
+#ifdef DISABLE_PERMUTATION_DEDUP
+    // Every permutation of a leaf is its own leaf, so the stored leaves cannot
+    // be matched up against the ones we would search for.
+    std::cout << "WARNING: Incremental runs require permutation dedup. "
+              << "Running a full search instead." << std::endl;
+    FindWorstWordle(useFutures, true);
     return;
 #endif
+    if (previous.flags != ResultDatabase::BuildFlags()) {
+      std::cout << "WARNING: The result database was built with different "
+                << "flags. Running a full search instead." << std::endl;
+      FindWorstWordle(useFutures, true);
+      return;
+    }
+    recordLeaves = true;
+    // Leaves found here are not in search order.
+    reorderLeaves = true;
+    StartExpansion(useFutures);
+
+    const std::unordered_set<SetId> oldGuessIds(previous.guessSetIds.begin(),
+                                                previous.guessSetIds.end());
+    const std::unordered_set<SetId> oldAnswerIds(
+        previous.answerSetIds.begin(), previous.answerSetIds.end());
+    std::unordered_set<SetId> newGuessIds;
+    std::vector<LetterSet> addedGuessSets;
+    std::vector<LetterSet> unchangedGuessSets;
+    for (const auto& set : guessSets) {
+      newGuessIds.insert(set.GetId());
+      if (oldGuessIds.count(set.GetId())) {
+        unchangedGuessSets.push_back(set);
+      } else {
+        addedGuessSets.push_back(set);
+      }
+    }
+    std::vector<LetterSet> addedAnswerSets;
+    for (const auto& set : answerSets) {
+      if (!oldAnswerIds.count(set.GetId())) {
+        addedAnswerSets.push_back(set);
+      }
+    }
+    // Keep stdout identical to a full run.
+    std::cerr << "Reusing " << previous.leaves.size() << " stored leaves with "
+              << addedGuessSets.size() << " added and "
+              << (previous.guessSetIds.size() - unchangedGuessSets.size())
+              << " removed guess sets and " << addedAnswerSets.size()
+              << " added answer sets" << std::endl;
 
-    // Handle the initial, vowelless words first.
-    // We can safely ignore all of the words with vowels from the first level of
-    // our DFS due to the following properties:
-    // - There are 6 guesses and 1 answer per solution.
-    // - There are 6 vowels in the alphabet.
-    // - All words in the answers wordlist contain vowels.
-    // - There are words in the guesses wordlist that do not contain vowels.
-    // - Because of this, we know that 1 of the guesses must be a vowelless
-    // word.
-
-    // Checking every set may cause a minor increase in run time, but it is
-    // safer this way.
-    size_t vowellessCount = 0;
-    for (size_t i = 0; i < guessSets.size(); ++i) {
-      if (!guessSets[i].hasVowel()) {
-        ++vowellessCount;
-        const LetterSet& usedLetters = guessSets[i];
-        chosenSets.push_back(usedLetters);
-        const std::vector<LetterSet> pruned =
-            PruneSets(usedLetters, i + 1, guessSets);
-        FindWorstWordleRecursive(chosenSets, usedLetters, pruned, useFutures);
-        chosenSets.pop_back();
+    std::vector<LetterSet> chosenSets;
+    chosenSets.reserve(6);
+    // Search from each added guess set in turn. Later added sets are left out
+    // of each search, so a leaf with several added sets is only found once,
+    // from the first one it contains.
+    std::unordered_set<SetId> searchedIds;
+    for (const auto& added : addedGuessSets) {
+      searchedIds.insert(added.GetId());
+      std::vector<LetterSet> sets;
+      for (const auto& set : guessSets) {
+        if (!(set & added).GetSet().any() && !searchedIds.count(set.GetId())) {
+          sets.push_back(set);
+        }
       }
+      chosenSets.push_back(added);
+      FindWorstWordleStart(chosenSets, added, sets, useFutures);
+      chosenSets.pop_back();
     }
-#ifdef DEBUG
-    std::cout << "Found " << vowellessCount << " vowelless letter sets"
-              << std::endl;
-    // Check to make sure all vowelless sets come first.
-    size_t prefix = 0, total = 0;
-    for (size_t i = 0; i < guessSets.size(); ++i) {
-      if (!hasVowel(guessSets[i])) {
-        ++total;
-        if (prefix == i) ++prefix;  // count leading block
+    WaitForFutures();
+
+    // Search the unchanged guess sets for leaves that have no valid answers
+    // other than the added ones, skipping the leaves we already have.
+    if (!addedAnswerSets.empty()) {
+      requiredAnswerSets = addedAnswerSets;
+      knownLeaves.insert(previous.leaves.begin(), previous.leaves.end());
+      FindWorstWordleStart(chosenSets, LetterSet(), unchangedGuessSets,
+                           useFutures);
+    }
+
+    // Expand the stored leaves while any searches run in the background.
+    for (const Leaf& leaf : previous.leaves) {
+      bool removed = false;
+      LetterSet usedLetters;
+      chosenSets.clear();
+      for (const SetId id : leaf) {
+        if (!newGuessIds.count(id)) {
+          removed = true;
+          break;
+        }
+        chosenSets.push_back(LetterSet(std::bitset<26>(id)));
+        usedLetters = usedLetters | chosenSets.back();
+      }
+      if (!removed) {
+        EmitLeaf(usedLetters, chosenSets);
       }
     }
-    assert(prefix == total && "Comparator must place all vowelless sets first");
-#endif
+    WaitForFutures();
+    FinishExpansion();
 
-    // Wait for all parallel tasks to complete.
-    for (auto& f : futures) {
-      f.get();
+    requiredAnswerSets.clear();
+    knownLeaves.clear();
+    reorderLeaves = false;
+  }
+
+  // Save the leaves recorded by the last search, along with the wordlists
+  // they were found for.
+  void SaveDatabase(const std::filesystem::path& file) {
+    database.guessSetIds.clear();
+    for (const auto& set : guessSets) {
+      database.guessSetIds.push_back(set.GetId());
+    }
+    std::sort(database.guessSetIds.begin(), database.guessSetIds.end());
+    database.answerSetIds.clear();
+    for (const auto& set : answerSets) {
+      database.answerSetIds.push_back(set.GetId());
     }
+    std::sort(database.answerSetIds.begin(), database.answerSetIds.end());
+    // Leaves are recorded in whatever order the threads find them.
+    std::sort(database.leaves.begin(), database.leaves.end());
+    database.Save(file);
   }
 
  private:
+  // A leaf of the DFS, as passed from the search to the expansion stage.
+  struct LeafRecord {
+    SetId usedLetters;
+    // In the order they were chosen.
+    std::array<SetId, 6> sets;
+  };
+  // Shared across all of the queues, so memory use does not grow with the
+  // number of expansion threads.
+  static constexpr size_t kLeafQueueTotalCapacity = 1 << 18;
+  static constexpr size_t kMinLeafQueueCapacity = 1 << 10;
+
   const std::vector<Word> GetWordlist(const std::filesystem::path& file) {
     std::vector<Word> words;
     std::ifstream in(file);
@@ -346,6 +597,78 @@ class WorstWordle {
     return pruned;
   }
 
+  // Continue the DFS from chosenSets, choosing the remaining sets from sets.
+  void FindWorstWordleStart(std::vector<LetterSet>& chosenSets,
+                            const LetterSet& usedLetters,
+                            const std::vector<LetterSet>& sets,
+                            const bool& useFutures) {
+#ifdef DISABLE_VOWEL_OPTIMIZATION
+    FindWorstWordleRecursive(chosenSets, usedLetters, sets, useFutures);
+    return;
+#endif
+    for (const auto& set : chosenSets) {
+      if (!set.hasVowel()) {
+        // The mandatory vowelless set has already been chosen.
+        FindWorstWordleRecursive(chosenSets, usedLetters, sets, useFutures);
+        return;
+      }
+    }
+
+    // Handle the initial, vowelless words first.
+    // We can safely ignore all of the words with vowels from the first level of
+    // our DFS due to the following properties:
+    // - There are 6 guesses and 1 answer per solution.
+    // - There are 6 vowels in the alphabet.
+    // - All words in the answers wordlist contain vowels.
+    // - There are words in the guesses wordlist that do not contain vowels.
+    // - Because of this, we know that 1 of the guesses must be a vowelless
+    // word.
+
+    // Checking every set may cause a minor increase in run time, but it is
+    // safer this way.
+    size_t vowellessCount = 0;
+    for (size_t i = 0; i < sets.size(); ++i) {
+      if (!sets[i].hasVowel()) {
+        ++vowellessCount;
+        const LetterSet& set = sets[i];
+        chosenSets.push_back(set);
+        const std::vector<LetterSet> pruned = PruneSets(set, i + 1, sets);
+        FindWorstWordleRecursive(chosenSets, usedLetters | set, pruned,
+                                 useFutures);
+        chosenSets.pop_back();
+      }
+    }
+#ifdef DEBUG
+    std::cout << "Found " << vowellessCount << " vowelless letter sets"
+              << std::endl;
+    // Check to make sure all vowelless sets come first.
+    size_t prefix = 0, total = 0;
+    for (size_t i = 0; i < sets.size(); ++i) {
+      if (!sets[i].hasVowel()) {
+        ++total;
+        if (prefix == i) ++prefix;  // count leading block
+      }
+    }
+    assert(prefix == total && "Comparator must place all vowelless sets first");
+#endif
+  }
+
+  void WaitForFutures() {
+    for (auto& f : futures) {
+      f.get();
+    }
+    futures.clear();
+  }
+
+  static Leaf ToLeaf(const std::vector<LetterSet>& chosenSets) {
+    Leaf leaf;
+    for (size_t i = 0; i < leaf.size(); ++i) {
+      leaf[i] = chosenSets[i].GetId();
+    }
+    std::sort(leaf.begin(), leaf.end());
+    return leaf;
+  }
+
   void PrintSolution(const Word& answer, const std::vector<Word>& guesses,
                      const size_t& solutionCount) {
     // Sorting takes longer but keeps the output well-organized.
@@ -422,12 +745,26 @@ class WorstWordle {
       }
     }
 
+    if (recordLeaves && !validAnswers.empty()) {
+      std::lock_guard<std::mutex> lock(databaseMutex);
+      database.leaves.push_back(ToLeaf(chosenSets));
+    }
+
+    // Match the guess order of a full run.
+    std::vector<LetterSet> sortedSets;
+    if (reorderLeaves) {
+      sortedSets = chosenSets;
+      std::sort(sortedSets.begin(), sortedSets.end(), LetterSet::Compare());
+    }
+    const std::vector<LetterSet>& orderedSets =
+        reorderLeaves ? sortedSets : chosenSets;
+
     // Get all combinations of valid words.
     std::vector<std::vector<Word>> combinations;
-    combinations.reserve(chosenSets.size());
-    for (size_t i = 0; i < chosenSets.size(); ++i) {
+    combinations.reserve(orderedSets.size());
+    for (size_t i = 0; i < orderedSets.size(); ++i) {
       combinations.push_back({});
-      const auto& chosenSet = chosenSets[i];
+      const auto& chosenSet = orderedSets[i];
       // TODO: This access somehow isn't thread-safe. This issue will appear
       // when using multithreading but disabling the vowel optimization.
       auto range = setToWordsGuess.equal_range(chosenSet);
@@ -447,15 +784,110 @@ class WorstWordle {
     FindWorstWordsRec(validAnswers, combinations, 0, solution);
   }
 
+  // Hand a leaf over to the expansion stage, or expand it right away if the
+  // stage is not running.
+  void EmitLeaf(const LetterSet& usedLetters,
+                const std::vector<LetterSet>& chosenSets) {
+    if (leafQueues.empty()) {
+      FindWorstWords(usedLetters, chosenSets);
+      return;
+    }
+    LeafRecord record;
+    record.usedLetters = usedLetters.GetId();
+    for (size_t i = 0; i < record.sets.size(); ++i) {
+      record.sets[i] = chosenSets[i].GetId();
+    }
+    // Each thread deals its leaves out across the queues in turn, skipping
+    // over any that are full.
+    thread_local size_t next =
+        std::hash<std::thread::id>{}(std::this_thread::get_id());
+    for (size_t i = 0; i < leafQueues.size(); ++i) {
+      if (leafQueues[next++ % leafQueues.size()]->TryPush(record)) {
+        return;
+      }
+    }
+    // Every queue is full, so the expansion stage is the bottleneck. Rather
+    // than wait for it to catch up, help it out.
+    FindWorstWords(usedLetters, chosenSets);
+  }
+
+  // The main loop of an expansion thread, which is the only consumer of queue.
+  void ExpandLeaves(MpscQueue<LeafRecord>& queue) {
+    LeafRecord record;
+    std::vector<LetterSet> chosenSets;
+    chosenSets.reserve(6);
+    Backoff backoff;
+    while (true) {
+      // Check before popping, so that nothing can be pushed in between.
+      const bool done = searchDone.load(std::memory_order_acquire);
+      if (queue.TryPop(record)) {
+        chosenSets.clear();
+        for (const SetId id : record.sets) {
+          chosenSets.push_back(LetterSet(std::bitset<26>(id)));
+        }
+        FindWorstWords(LetterSet(std::bitset<26>(record.usedLetters)),
+                       chosenSets);
+        backoff.Reset();
+      } else if (done) {
+        return;
+      } else {
+        backoff.Wait();
+      }
+    }
+  }
+
+  // Start the expansion threads, each with its own queue. Without futures,
+  // leaves are expanded on the thread that finds them.
+  void StartExpansion(const bool& useFutures) {
+    if (!useFutures) {
+      return;
+    }
+    searchDone.store(false, std::memory_order_release);
+    // The largest power of two that fits each queue's share.
+    size_t capacity = kMinLeafQueueCapacity;
+    while (capacity * 2 * expandThreads <= kLeafQueueTotalCapacity) {
+      capacity *= 2;
+    }
+    for (size_t i = 0; i < expandThreads; ++i) {
+      leafQueues.push_back(std::make_unique<MpscQueue<LeafRecord>>(capacity));
+    }
+    for (size_t i = 0; i < expandThreads; ++i) {
+      expanders.emplace_back(&WorstWordle::ExpandLeaves, this,
+                             std::ref(*leafQueues[i]));
+    }
+  }
+
+  // Must only be called once every leaf has been emitted.
+  void FinishExpansion() {
+    searchDone.store(true, std::memory_order_release);
+    for (auto& expander : expanders) {
+      expander.join();
+    }
+    expanders.clear();
+    leafQueues.clear();
+  }
+
   // Recursive helper function to find combinations
   void FindWorstWordleRecursive(std::vector<LetterSet>& chosenSets,
                                 const LetterSet& usedLetters,
                                 const std::vector<LetterSet>& guessSets,
                                 const bool& useFutures = false) {
+    // Skip subtrees that cannot be valid for any of the required answers.
+    if (!requiredAnswerSets.empty() &&
+        std::none_of(requiredAnswerSets.begin(), requiredAnswerSets.end(),
+                     [&usedLetters](const LetterSet& answerSet) {
+                       return !(answerSet & usedLetters).GetSet().any();
+                     })) {
+      return;
+    }
     // Base case: if we have 6 sets, score them.
     if (chosenSets.size() >= 6) {
-      // This recursive call converts our sets into concrete word solutions.
-      FindWorstWords(usedLetters, chosenSets);
+      if (!knownLeaves.empty() && knownLeaves.count(ToLeaf(chosenSets))) {
+        // This leaf was already stored, and is expanded separately.
+        return;
+      }
+      // The expansion stage converts our sets into concrete word solutions.
+      EmitLeaf(usedLetters, chosenSets);
       // NOTE: If we don't return, we can find solutions with more than 6
       // guesses.
       return;
@@ -498,6 +930,7 @@ class WorstWordle {
   }
 
   std::chrono::steady_clock::time_point startTime;
+  const size_t expandThreads;
   const std::vector<Word> guessWords;
   const std::vector<Word> ansWords;
   // Not const because we must sort this list after reading it.
@@ -507,12 +940,28 @@ class WorstWordle {
       setToWordsGuess;
   const std::unordered_multimap<LetterSet, Word, LetterSet::Hash> setToWordsAns;
 
-  static ThreadPool pool;
+  // Runs the search, while the expansion stage has threads of its own.
+  ThreadPool pool;
   std::atomic<size_t> solutions = 0;
   std::mutex printMutex;
   std::vector<std::future<void>> futures;
+
+  // The expansion stage.
+  std::vector<std::unique_ptr<MpscQueue<LeafRecord>>> leafQueues;
+  std::vector<std::thread> expanders;
+  std::atomic<bool> searchDone = false;
+
+  // Leaves with valid answers are recorded here when recordLeaves is set.
+  ResultDatabase database;
+  std::mutex databaseMutex;
+  bool recordLeaves = false;
+  // Set when leaves are not found in search order.
+  bool reorderLeaves = false;
+  // When not empty, only search for leaves valid for one of these answers.
+  std::vector<LetterSet> requiredAnswerSets;
+  // When not empty, skip these leaves.
+  std::unordered_set<Leaf, ResultDatabase::LeafHash> knownLeaves;
 };
 
 // Definition of the static member variables.
-ThreadPool WorstWordle::pool(std::thread::hardware_concurrency());
 std::unordered_map<char, double> LetterSet::letterFrequency;
\ No newline at end of file